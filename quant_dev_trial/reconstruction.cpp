@@ -4,10 +4,37 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <deque>
 #include <unordered_map>
 #include <algorithm>
 #include <iomanip>
 #include <chrono>
+#include <functional>
+#include <thread>
+#include <csignal>
+#include <stdexcept>
+
+// Fixed-size input and output-file buffers; stdout keeps its default buffer
+static constexpr std::size_t kStreamBufferSize = 1 << 16;
+// Upper bound on unmatched trades awaiting their F/C records
+static constexpr std::size_t kMaxPendingTrades = 1024;
+
+// Set from SIGINT/SIGTERM (SIGBREAK on Windows) so --follow can stop and flush cleanly
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void requestStop(int) {
+    stop_requested = 1;
+}
+
+// libstdc++ only honours setbuf before open(), MSVC only after it (setvbuf on
+// the FILE*), so ask at both points - the unsupported call is a no-op
+static void openBuffered(std::ofstream& stream, const std::string& filename, std::vector<char>& buffer) {
+    stream.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    stream.open(filename);
+    if (stream.is_open()) {
+        stream.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    }
+}
 
 struct OrderBookLevel {
     double price;
@@ -167,10 +194,63 @@ public:
     }
 };
 
+struct StreamOptions {
+    std::chrono::milliseconds flush_budget{50};  // Max time output may sit unflushed
+    bool follow = false;                         // Keep reading as the input file grows
+};
+
+// Pulls input through a fixed buffer and calls on_block before any read that
+// could wait on the writer, so finished rows never sit behind a partial record
+class BlockAwareInputBuffer : public std::streambuf {
+private:
+    std::streambuf* source;
+    std::vector<char>& buffer;
+    std::function<void()> on_block;
+    
+public:
+    BlockAwareInputBuffer(std::streambuf* src, std::vector<char>& buf, std::function<void()> callback)
+        : source(src), buffer(buf), on_block(std::move(callback)) {}
+    
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        
+        // in_avail() <= 0 means the source has nothing buffered and the pipe/file
+        // reports nothing ready (or can't tell), so the next read may block
+        std::streamsize ready = source->in_avail();
+        std::streamsize count = 0;
+        if (ready <= 0) {
+            on_block();
+            int_type c = source->sbumpc();
+            if (traits_type::eq_int_type(c, traits_type::eof())) {
+                return traits_type::eof();
+            }
+            buffer[count++] = traits_type::to_char_type(c);
+            ready = source->in_avail();
+        }
+        
+        // Only take what is already available so this never blocks mid-buffer
+        std::streamsize space = static_cast<std::streamsize>(buffer.size()) - count;
+        if (ready > 0) {
+            count += source->sgetn(buffer.data() + count, std::min(ready, space));
+        }
+        
+        setg(buffer.data(), buffer.data(), buffer.data() + count);
+        return traits_type::to_int_type(*gptr());
+    }
+};
+
 class OrderBookReconstructor {
 private:
     OrderBook orderbook;
+    std::vector<char> input_buffer;   // Declared before the streams that use them
+    std::vector<char> output_buffer;
     std::ofstream output_file;
+    std::ostream& output;
+    StreamOptions options;
+    std::chrono::steady_clock::time_point last_flush;
     int row_index;
     
     // Track pending trades for T->F->C sequence
@@ -190,68 +270,90 @@ private:
         int order_id;
     };
     
-    std::vector<PendingTrade> pending_trades;
+    std::deque<PendingTrade> pending_trades;
+    std::size_t evicted_trades = 0;
     
 public:
-    OrderBookReconstructor(const std::string& output_filename) 
-        : output_file(output_filename), row_index(0) {
+    // An output filename of "-" writes to stdout; named pipes work like regular files
+    OrderBookReconstructor(const std::string& output_filename, const StreamOptions& opts = StreamOptions())
+        : input_buffer(kStreamBufferSize), output_buffer(kStreamBufferSize),
+          output(output_filename == "-" ? std::cout : output_file),
+          options(opts), last_flush(std::chrono::steady_clock::now()), row_index(0) {
+        if (&output == &output_file) {
+            openBuffered(output_file, output_filename, output_buffer);
+        }
         writeHeader();
     }
     
     ~OrderBookReconstructor() {
+        output.flush();
         if (output_file.is_open()) {
             output_file.close();
         }
     }
     
+    bool isOpen() const {
+        return &output != &output_file || output_file.is_open();
+    }
+    
+    // Trades dropped from the pending list before their C arrived
+    std::size_t evictedTrades() const {
+        return evicted_trades;
+    }
+    
+    void flushOutput() {
+        output.flush();
+        last_flush = std::chrono::steady_clock::now();
+    }
+    
     void writeHeader() {
-        output_file << ",ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,depth,price,size,flags,ts_in_delta,sequence";
+        output << ",ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,depth,price,size,flags,ts_in_delta,sequence";
         
         // Write bid/ask columns for 10 levels
         for (int i = 0; i < 10; ++i) {
-            output_file << ",bid_px_" << std::setfill('0') << std::setw(2) << i
-                       << ",bid_sz_" << std::setfill('0') << std::setw(2) << i
-                       << ",bid_ct_" << std::setfill('0') << std::setw(2) << i
-                       << ",ask_px_" << std::setfill('0') << std::setw(2) << i
-                       << ",ask_sz_" << std::setfill('0') << std::setw(2) << i
-                       << ",ask_ct_" << std::setfill('0') << std::setw(2) << i;
+            output << ",bid_px_" << std::setfill('0') << std::setw(2) << i
+                  << ",bid_sz_" << std::setfill('0') << std::setw(2) << i
+                  << ",bid_ct_" << std::setfill('0') << std::setw(2) << i
+                  << ",ask_px_" << std::setfill('0') << std::setw(2) << i
+                  << ",ask_sz_" << std::setfill('0') << std::setw(2) << i
+                  << ",ask_ct_" << std::setfill('0') << std::setw(2) << i;
         }
         
-        output_file << ",symbol,order_id\n";
+        output << ",symbol,order_id\n";
     }
     
     void writeMBPRecord(const MBORecord& record, char effective_action, char effective_side, int depth) {
         auto bids = orderbook.getBids(10);
         auto asks = orderbook.getAsks(10);
         
-        output_file << row_index << "," << record.ts_event << "," << record.ts_event << ","
-                   << "10" << "," << record.publisher_id << "," << record.instrument_id << ","
-                   << effective_action << "," << effective_side << "," << depth << ",";
+        output << row_index << "," << record.ts_event << "," << record.ts_event << ","
+              << "10" << "," << record.publisher_id << "," << record.instrument_id << ","
+              << effective_action << "," << effective_side << "," << depth << ",";
         
         if (record.price > 0) {
-            output_file << std::fixed << std::setprecision(8) << record.price;
+            output << std::fixed << std::setprecision(8) << record.price;
         }
-        output_file << "," << record.size << "," << record.flags << ","
-                   << record.ts_in_delta << "," << record.sequence;
+        output << "," << record.size << "," << record.flags << ","
+              << record.ts_in_delta << "," << record.sequence;
         
         // Write 10 levels of bid/ask data
         for (int i = 0; i < 10; ++i) {
             if (i < static_cast<int>(bids.size())) {
-                output_file << "," << std::fixed << std::setprecision(2) << bids[i].price
-                           << "," << bids[i].size << "," << bids[i].count;
+                output << "," << std::fixed << std::setprecision(2) << bids[i].price
+                      << "," << bids[i].size << "," << bids[i].count;
             } else {
-                output_file << ",,0,0";
+                output << ",,0,0";
             }
             
             if (i < static_cast<int>(asks.size())) {
-                output_file << "," << std::fixed << std::setprecision(2) << asks[i].price
-                           << "," << asks[i].size << "," << asks[i].count;
+                output << "," << std::fixed << std::setprecision(2) << asks[i].price
+                      << "," << asks[i].size << "," << asks[i].count;
             } else {
-                output_file << ",,0,0";
+                output << ",,0,0";
             }
         }
         
-        output_file << "," << record.symbol << "," << record.order_id << "\n";
+        output << "," << record.symbol << "," << record.order_id << "\n";
         row_index++;
     }
     
@@ -289,6 +391,11 @@ public:
             // The actual side affected is opposite to the trade side
             trade.actual_side = (record.side == 'B') ? 'A' : 'B';
             
+            // A T without its closing C should not grow memory without bound
+            if (pending_trades.size() >= kMaxPendingTrades) {
+                pending_trades.pop_front();
+                evicted_trades++;
+            }
             pending_trades.push_back(trade);
             return;
         }
@@ -403,17 +510,56 @@ public:
         }
     }
     
+    // A filename of "-" reads from stdin; follow mode only applies to real files
     void processFile(const std::string& filename) {
+        if (filename == "-") {
+            processStream(std::cin, false);
+            return;
+        }
+        
         std::ifstream file(filename);
         if (!file.is_open()) {
             std::cerr << "Error: Cannot open file " << filename << std::endl;
             return;
         }
         
+        processStream(file, options.follow);
+        file.close();
+    }
+    
+    void processStream(std::istream& source, bool follow) {
+        BlockAwareInputBuffer input_buf(source.rdbuf(), input_buffer, [this]() { flushOutput(); });
+        std::istream input(&input_buf);
         std::string line;
+        std::string partial;  // Trailing bytes of a record the writer hasn't finished yet
         bool first_line = true;
+        auto poll_interval = std::max(options.flush_budget, std::chrono::milliseconds(1));
         
-        while (std::getline(file, line)) {
+        while (!stop_requested) {
+            if (!std::getline(input, line)) {
+                if (!follow) break;
+                
+                // Caught up with the writer - publish what we have and wait for more
+                flushOutput();
+                input.clear();
+                std::this_thread::sleep_for(poll_interval);
+                continue;
+            }
+            
+            if (input.eof() && follow) {
+                // No newline yet, so the record may still be growing
+                partial += line;
+                flushOutput();
+                input.clear();
+                std::this_thread::sleep_for(poll_interval);
+                continue;
+            }
+            
+            if (!partial.empty()) {
+                line.insert(0, partial);
+                partial.clear();
+            }
+            
             if (first_line) {
                 first_line = false;
                 continue; // Skip header
@@ -424,31 +570,101 @@ public:
                 MBORecord record = CSVParser::parseMBORecord(fields);
                 processRecord(record);
             }
+            
+            // Input that may block is handled by input_buf; this caps lag on a busy feed
+            if (std::chrono::steady_clock::now() - last_flush >= options.flush_budget) {
+                flushOutput();
+            }
         }
         
-        file.close();
+        flushOutput();
     }
 };
 
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] <mbo_input_file.csv | ->\n"
+              << "  -o <file | ->      Output path, '-' for stdout (default: reconstructed_mbp.csv)\n"
+              << "  --flush-ms <n>     Flush output at least every n ms (default: 50)\n"
+              << "  --follow           Keep reading as the input file grows (stop with Ctrl+C)"
+              << std::endl;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <mbo_input_file.csv>" << std::endl;
+    std::string input_file;
+    std::string output_file = "reconstructed_mbp.csv";
+    StreamOptions options;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (arg == "--flush-ms" && i + 1 < argc) {
+            try {
+                int ms = std::stoi(argv[++i]);
+                if (ms < 0) throw std::invalid_argument("negative");
+                options.flush_budget = std::chrono::milliseconds(ms);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid --flush-ms value " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--follow") {
+            options.follow = true;
+        } else if (input_file.empty() && (arg == "-" || arg[0] != '-')) {
+            input_file = arg;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (input_file.empty()) {
+        printUsage(argv[0]);
         return 1;
     }
     
-    std::string input_file = argv[1];
-    std::string output_file = "reconstructed_mbp.csv";
+    if (options.follow && input_file == "-") {
+        std::cerr << "Error: --follow requires an input file, not stdin" << std::endl;
+        return 1;
+    }
+    
+    // Avoids per-character stdio synchronisation on cin/cout, and stops cin
+    // flushing cout before every read, which would defeat the output buffer
+    std::ios::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    
+    if (options.follow) {
+        std::signal(SIGINT, requestStop);
+        std::signal(SIGTERM, requestStop);
+#ifdef SIGBREAK
+        std::signal(SIGBREAK, requestStop);
+#endif
+    }
+    
+    // Keep stdout clean for MBP rows when it is the output
+    std::ostream& log = (output_file == "-") ? std::cerr : std::cout;
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    OrderBookReconstructor reconstructor(output_file);
-    reconstructor.processFile(input_file);
+    {
+        OrderBookReconstructor reconstructor(output_file, options);
+        if (!reconstructor.isOpen()) {
+            std::cerr << "Error: Cannot open output file " << output_file << std::endl;
+            return 1;
+        }
+        reconstructor.processFile(input_file);
+        
+        // Their C rows were written as plain cancels instead of trades
+        if (reconstructor.evictedTrades() > 0) {
+            std::cerr << "Warning: " << reconstructor.evictedTrades()
+                      << " pending trades evicted before their cancel arrived" << std::endl;
+        }
+    }
     
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     
-    std::cout << "Order book reconstruction completed in " << duration.count() << " ms" << std::endl;
-    std::cout << "Output written to: " << output_file << std::endl;
+    log << "Order book reconstruction completed in " << duration.count() << " ms" << std::endl;
+    log << "Output written to: " << (output_file == "-" ? "stdout" : output_file) << std::endl;
     
     return 0;
 }
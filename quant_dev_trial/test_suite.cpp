@@ -5,6 +5,16 @@
 #include <vector>
 #include <string>
 #include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 // Simple test framework
 class TestFramework {
@@ -77,6 +87,117 @@ std::vector<std::string> read_csv_lines(const std::string& filename) {
     return lines;
 }
 
+// Reconstructor started in the background, so a test can feed its stdin over
+// time and stop exactly this instance
+struct ChildProcess {
+#ifdef _WIN32
+    PROCESS_INFORMATION info{};
+    HANDLE stdin_write = nullptr;
+#else
+    pid_t pid = -1;
+    int stdin_write = -1;
+#endif
+};
+
+bool start_reconstructor(ChildProcess& child, const std::string& args, bool pipe_stdin) {
+#ifdef _WIN32
+    SECURITY_ATTRIBUTES sa{sizeof(sa), nullptr, TRUE};
+    HANDLE null_out = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_WRITE, &sa, OPEN_EXISTING, 0, nullptr);
+    HANDLE stdin_read = GetStdHandle(STD_INPUT_HANDLE);
+    if (pipe_stdin) {
+        CreatePipe(&stdin_read, &child.stdin_write, &sa, 0);
+        SetHandleInformation(child.stdin_write, HANDLE_FLAG_INHERIT, 0);
+    }
+    
+    STARTUPINFOA si{};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = stdin_read;
+    si.hStdOutput = null_out;
+    si.hStdError = null_out;
+    
+    // Own process group so Ctrl+Break reaches only this child
+    std::string cmd = "reconstruction_blockhouse.exe " + args;
+    BOOL ok = CreateProcessA(nullptr, &cmd[0], nullptr, nullptr, TRUE, CREATE_NEW_PROCESS_GROUP,
+                             nullptr, nullptr, &si, &child.info);
+    CloseHandle(null_out);
+    if (pipe_stdin) CloseHandle(stdin_read);
+    return ok != 0;
+#else
+    int fds[2] = {-1, -1};
+    if (pipe_stdin && pipe(fds) != 0) return false;
+    
+    std::cout.flush();
+    child.pid = fork();
+    if (child.pid == 0) {
+        if (pipe_stdin) {
+            dup2(fds[0], STDIN_FILENO);
+            close(fds[0]);
+            close(fds[1]);
+        }
+        int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDOUT_FILENO);
+        dup2(null_fd, STDERR_FILENO);
+        std::string cmd = "exec ./reconstruction_blockhouse " + args;
+        execl("/bin/sh", "sh", "-c", cmd.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    
+    if (pipe_stdin) {
+        close(fds[0]);
+        child.stdin_write = fds[1];
+    }
+    return child.pid > 0;
+#endif
+}
+
+void write_to_child(ChildProcess& child, const std::string& data) {
+#ifdef _WIN32
+    DWORD written = 0;
+    WriteFile(child.stdin_write, data.data(), static_cast<DWORD>(data.size()), &written, nullptr);
+#else
+    ssize_t written = write(child.stdin_write, data.data(), data.size());
+    (void)written;
+#endif
+}
+
+void close_child_stdin(ChildProcess& child) {
+#ifdef _WIN32
+    CloseHandle(child.stdin_write);
+    child.stdin_write = nullptr;
+#else
+    close(child.stdin_write);
+    child.stdin_write = -1;
+#endif
+}
+
+// Graceful stop: Ctrl+Break (SIGBREAK) on Windows, SIGINT elsewhere
+void interrupt_child(ChildProcess& child) {
+#ifdef _WIN32
+    GenerateConsoleCtrlEvent(CTRL_BREAK_EVENT, child.info.dwProcessId);
+#else
+    kill(child.pid, SIGINT);
+#endif
+}
+
+int wait_child(ChildProcess& child) {
+#ifdef _WIN32
+    DWORD exit_code = 1;
+    if (WaitForSingleObject(child.info.hProcess, 5000) == WAIT_OBJECT_0) {
+        GetExitCodeProcess(child.info.hProcess, &exit_code);
+    } else {
+        TerminateProcess(child.info.hProcess, 1);
+    }
+    CloseHandle(child.info.hProcess);
+    CloseHandle(child.info.hThread);
+    return static_cast<int>(exit_code);
+#else
+    int status = 0;
+    waitpid(child.pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
 void test_basic_functionality(TestFramework& tf) {
     std::cout << "\n=== Testing Basic Functionality ===" << std::endl;
     
@@ -186,6 +307,125 @@ void test_edge_cases(TestFramework& tf) {
     system("del empty_test.csv clear_test.csv 2>nul");
 }
 
+void test_streaming_mode(TestFramework& tf) {
+    std::cout << "\n=== Testing Streaming Mode ===" << std::endl;
+    
+    create_test_mbo_file("stream_test.csv");
+    
+    // Reference output from the regular file path
+    int result = system(".\\reconstruction_blockhouse.exe stream_test.csv > nul 2>&1");
+    auto file_lines = read_csv_lines("reconstructed_mbp.csv");
+    tf.assert_true(result == 0 && file_lines.size() > 1, "File mode produces reference output");
+    
+    // Same input through stdin, MBP written to stdout
+    result = system(".\\reconstruction_blockhouse.exe - -o - < stream_test.csv > stream_out.csv 2>nul");
+    tf.assert_true(result == 0, "Reads MBO from stdin and writes MBP to stdout");
+    
+    auto stream_lines = read_csv_lines("stream_out.csv");
+    tf.assert_true(stream_lines == file_lines, "Streaming output matches file output");
+    
+    result = system(".\\reconstruction_blockhouse.exe -o custom_out.csv stream_test.csv > nul 2>&1");
+    tf.assert_true(result == 0 && read_csv_lines("custom_out.csv") == file_lines, "Writes to a custom -o path");
+    
+    result = system(".\\reconstruction_blockhouse.exe --follow - > nul 2>&1");
+    tf.assert_true(result != 0, "Rejects --follow on stdin");
+    
+    result = system(".\\reconstruction_blockhouse.exe --flush-ms abc stream_test.csv > nul 2>&1");
+    tf.assert_true(result != 0, "Rejects non-numeric --flush-ms");
+    
+    result = system(".\\reconstruction_blockhouse.exe --flush-ms -5 stream_test.csv > nul 2>&1");
+    tf.assert_true(result != 0, "Rejects negative --flush-ms");
+    
+    // Unmatched trades past the 1024 pending cap must be reported, not dropped silently
+    std::ofstream evict_file("evict_test.csv");
+    evict_file << "ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,price,size,channel_id,order_id,flags,ts_in_delta,sequence,symbol\n";
+    for (int i = 1; i <= 1100; ++i) {
+        evict_file << "2025-07-17T08:05:03.360842448Z,2025-07-17T08:05:03.360677248Z,160,2,1108,T,A,5.51,100,0,0,130,165200,"
+                   << (900000 + i) << ",ARL\n";
+    }
+    evict_file.close();
+    
+    result = system(".\\reconstruction_blockhouse.exe -o evict_out.csv evict_test.csv > nul 2> evict_err.txt");
+    std::ifstream evict_err("evict_err.txt");
+    std::stringstream err_text;
+    err_text << evict_err.rdbuf();
+    evict_err.close();
+    tf.assert_true(result == 0 && err_text.str().find("76 pending trades evicted") != std::string::npos,
+                   "Reports pending trades evicted past the cap");
+    
+    system("del stream_test.csv stream_out.csv custom_out.csv evict_test.csv evict_out.csv evict_err.txt 2>nul");
+}
+
+void test_stream_latency(TestFramework& tf) {
+    std::cout << "\n=== Testing Stream Latency ===" << std::endl;
+    
+    ChildProcess child;
+    bool started = start_reconstructor(child, "--flush-ms 10 - -o latency_out.csv", true);
+    tf.assert_true(started, "Starts reconstructor reading from a pipe");
+    if (!started) return;
+    
+    // Complete rows followed by a record split across pipe writes, as a
+    // capture process writing fixed-size blocks would produce
+    write_to_child(child,
+        "ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,price,size,channel_id,order_id,flags,ts_in_delta,sequence,symbol\n"
+        "2025-07-17T07:05:09.035793433Z,2025-07-17T07:05:09.035627674Z,160,2,1108,R,N,,0,0,0,8,0,0,ARL\n"
+        "2025-07-17T08:05:03.360842448Z,2025-07-17T08:05:03.360677248Z,160,2,1108,A,B,5.51,100,0,1001,130,165200,851012,ARL\n"
+        "2025-07-17T08:05:03.360848793Z,2025-07-17T08:05:03.360683462Z,160,2,1108,A,A,21.33,100,0,1002,130,165331,851013,ARL\n"
+        "2025-07-17T08:05:03.361492517Z,2025-07-17T08:05:03.361327319Z,160,2,1108,A,B,5.9,");
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    
+    auto lines = read_csv_lines("latency_out.csv");
+    tf.assert_true(lines.size() == 4, "Rows before a split record are flushed within the budget");
+    
+    write_to_child(child, "100,0,1003,130,165198,851022,ARL\n");
+    close_child_stdin(child);
+    int exit_code = wait_child(child);
+    
+    lines = read_csv_lines("latency_out.csv");
+    tf.assert_true(exit_code == 0 && lines.size() == 5, "Split record is processed once completed");
+    
+    system("del latency_out.csv 2>nul");
+}
+
+void test_follow_mode(TestFramework& tf) {
+    std::cout << "\n=== Testing Follow Mode ===" << std::endl;
+    
+    // Start with one complete record and the first half of the next
+    std::ofstream capture("follow_test.csv");
+    capture << "ts_recv,ts_event,rtype,publisher_id,instrument_id,action,side,price,size,channel_id,order_id,flags,ts_in_delta,sequence,symbol\n";
+    capture << "2025-07-17T07:05:09.035793433Z,2025-07-17T07:05:09.035627674Z,160,2,1108,R,N,,0,0,0,8,0,0,ARL\n";
+    capture << "2025-07-17T08:05:03.360842448Z,2025-07-17T08:05:03.360677248Z,160,2,1108,A,B,5.51,";
+    capture.close();
+    
+    ChildProcess child;
+    bool started = start_reconstructor(child, "--follow --flush-ms 10 -o follow_out.csv follow_test.csv", false);
+    tf.assert_true(started, "Starts reconstructor in follow mode");
+    if (!started) return;
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    
+    auto lines = read_csv_lines("follow_out.csv");
+    tf.assert_true(lines.size() == 2, "Follow mode holds back a partial record");
+    
+    // Finish the record - it should now appear
+    capture.open("follow_test.csv", std::ios::app);
+    capture << "100,0,1001,130,165200,851012,ARL\n";
+    capture.close();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    
+    lines = read_csv_lines("follow_out.csv");
+    tf.assert_true(lines.size() == 3, "Follow mode emits the record once its newline arrives");
+    tf.assert_true(!lines.empty() && lines.back().find(",5.51,100,1,") != std::string::npos,
+                   "Completed record is reconstructed correctly");
+    
+    // Stop only this instance, through the same signal path as Ctrl+C
+    interrupt_child(child);
+    int exit_code = wait_child(child);
+    lines = read_csv_lines("follow_out.csv");
+    tf.assert_true(exit_code == 0 && lines.size() == 3, "Follow mode stops cleanly with complete output");
+    
+    system("del follow_test.csv follow_out.csv 2>nul");
+}
+
 int main() {
     TestFramework tf;
     
@@ -208,6 +448,9 @@ int main() {
     test_order_book_operations(tf);
     test_performance(tf);
     test_edge_cases(tf);
+    test_streaming_mode(tf);
+    test_stream_latency(tf);
+    test_follow_mode(tf);
     
     // Clean up
     system("del reconstructed_mbp.csv build.log 2>nul");